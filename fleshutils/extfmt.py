@@ -0,0 +1,122 @@
+#
+# Copyright (c) 2022 Antti Kervinen <antti.kervinen@gmail.com>
+#
+# License (MIT):
+#
+# Permission is hereby granted, free of charge, to any person
+# obtaining a copy of this software and associated documentation files
+# (the "Software"), to deal in the Software without restriction,
+# including without limitation the rights to use, copy, modify, merge,
+# publish, distribute, sublicense, and/or sell copies of the Software,
+# and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be
+# included in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+# MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+# NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+# BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+# ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""extfmt - compiled extended printf-style formats
+
+Extended format is a printf-style format string with normal
+%(variable)<specifier> conversions and %((<expression>))<specifier>
+conversions, where <expression> is Python code evaluated in the
+namespace of format variables:
+
+  fmt = ExtFormat("%(new)d (%(((new-old)*100/old)).1f%%)")
+  fmt.format({'old': 40, 'new': 50}) # -> "50 (25.0%)"
+
+Expressions are compiled only once. Formats without expressions are
+formatted directly with the % operator.
+"""
+
+import re
+import types
+
+_re_code_conversion = re.compile(
+    r'%\(\((?P<expr>.*?)\)\)(?P<specifier>([0-9]*\.?[0-9]*)[diouxXeEfFgGcrsa])')
+
+_re_variable_conversion = re.compile(r'%%|%\((?P<var>[^)]*)\)')
+
+def nomatch_match(re_pattern, s):
+    """iterate (non_matching_prefix_of_s, groupdict/None) of regexp in s"""
+    _s = s
+    m = re_pattern.search(_s)
+    while m:
+        yield _s[:m.start()], m.groupdict()
+        _s = _s[m.end():]
+        m = re_pattern.search(_s)
+    yield _s, None
+
+def code_names(code):
+    """returns set of names used in CODE object and code nested in it"""
+    names = set(code.co_names)
+    for const in code.co_consts:
+        if isinstance(const, types.CodeType):
+            names |= code_names(const)
+    return names
+
+def parse_code_format(fmt):
+    """returns (list_of_(var_name, expr), no_code_fmt)"""
+    list_of_exprs = []
+    no_code_fmt = []
+    for index, (before, d) in enumerate(nomatch_match(_re_code_conversion, fmt)):
+        no_code_fmt.append(before)
+        if d is None:
+            break
+        var_name = "__exc_fmt_%d__" % (index,)
+        list_of_exprs.append((var_name, d['expr']))
+        no_code_fmt.append("%(" + var_name + ")" + d['specifier'])
+    return list_of_exprs, "".join(no_code_fmt)
+
+class ExtFormat(object):
+    """extended printf-style format with precompiled expressions
+
+    Attributes:
+      source: original format string
+      fmt:    format string where expressions are replaced by variables
+      exprs:  list of (var_name, expr) in fmt
+    """
+    def __init__(self, source):
+        self.source = source
+        self.exprs, self.fmt = parse_code_format(source)
+        self._codes = [(var_name, compile(expr.strip(), "<format %r>" % (source,), "eval"))
+                       for var_name, expr in self.exprs]
+        if not self._codes:
+            # nothing to evaluate, format VARIABLES as they are
+            self.format = self.fmt.__mod__
+
+    def replace(self, old, new):
+        """returns copy of the format with OLD replaced by NEW outside expressions"""
+        other = ExtFormat.__new__(ExtFormat)
+        other.__dict__.update(self.__dict__)
+        other.fmt = self.fmt.replace(old, new)
+        if not other._codes:
+            other.format = other.fmt.__mod__
+        return other
+
+    def names(self):
+        """returns set of names used in expressions"""
+        names = set()
+        for _, code in self._codes:
+            names |= code_names(code)
+        return names
+
+    def keys(self):
+        """returns set of variables in %(variable) conversions"""
+        return (set(m.group('var') for m in _re_variable_conversion.finditer(self.fmt)
+                    if m.group('var') is not None)
+                - set(var_name for var_name, _ in self.exprs))
+
+    def format(self, variables):
+        """returns formatted string, stores expression values to VARIABLES"""
+        for var_name, code in self._codes:
+            variables[var_name] = eval(code, variables)
+        return self.fmt % variables
@@ -7,7 +7,7 @@ setup(name         = 'fleshutils',
       description  = 'Collection of scripts that supplement coreutils',
       author       = 'Antti Kervinen',
       author_email = 'antti.kervinen@gmail.com',
-      packages     = [],
+      packages     = ['fleshutils'],
       package_data = {},
       scripts      = ['bin/bracketshr',
                       'bin/epochfilt',